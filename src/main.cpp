@@ -19,18 +19,157 @@
 #include <string>
 #include <vector>
 #include <cstring>
+#include <cstdio>
+#include <cerrno>
+#include <cctype>
 #include <filesystem>
 #include <algorithm>
 #include <map>
+#include <set>
+#include <unordered_map>
+#include <cstdint>
 #include <fstream>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <csignal>
+#include <sstream>
+#include <iterator>
+#include <cfloat>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SLICER_SSE2 1
+#endif
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
 
 namespace fs = std::filesystem;
 
+// Helpers used only by the inotify-based watch mode.
+#ifdef __linux__
+static bool isImageFile(const fs::path& path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+    return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp" || ext == ".tga";
+}
+
+static std::atomic<bool> watchStopRequested{false};
+
+static void watchSignalHandler(int) {
+    watchStopRequested = true;
+}
+#endif
+
+#ifndef GL_RG
+#define GL_RG 0x8227
+#endif
+#ifndef GL_R8
+#define GL_R8 0x8229
+#define GL_RG8 0x822B
+#define GL_R16 0x822A
+#define GL_RG16 0x822C
+#endif
+#ifndef GL_TEXTURE_SWIZZLE_RGBA
+#define GL_TEXTURE_SWIZZLE_RGBA 0x8E46
+#endif
+
+// Converts count pixels between grey, grey+alpha, RGB and RGBA layouts of the
+// same sample type. Each layout pair gets its own fixed-stride loop so the
+// compiler can vectorize it; colour to grey uses Rec. 601 luma weights.
+template <typename T, int SrcChannels, int DstChannels>
+static void convertChannelsFixed(const T* src, T* dst, size_t count) {
+    constexpr uint32_t maxValue = (T)~T(0);
+    for (size_t i = 0; i < count; i++) {
+        const T* s = src + i * SrcChannels;
+        T* d = dst + i * DstChannels;
+        uint32_t r = s[0];
+        uint32_t g = (SrcChannels >= 3) ? s[1 % SrcChannels] : r;
+        uint32_t b = (SrcChannels >= 3) ? s[2 % SrcChannels] : r;
+        uint32_t a = (SrcChannels == 2 || SrcChannels == 4) ? s[SrcChannels - 1] : maxValue;
+
+        if (DstChannels <= 2) {
+            d[0] = (T)((SrcChannels >= 3) ? (r * 77 + g * 150 + b * 29 + 128) >> 8 : r);
+        } else {
+            d[0] = (T)r;
+            d[1 % DstChannels] = (T)g;
+            d[2 % DstChannels] = (T)b;
+        }
+        if (DstChannels == 2 || DstChannels == 4) d[DstChannels - 1] = (T)a;
+    }
+}
+
+template <typename T, int SrcChannels>
+static void convertChannelsFrom(const T* src, T* dst, int dstChannels, size_t count) {
+    switch (dstChannels) {
+        case 1: convertChannelsFixed<T, SrcChannels, 1>(src, dst, count); break;
+        case 2: convertChannelsFixed<T, SrcChannels, 2>(src, dst, count); break;
+        case 3: convertChannelsFixed<T, SrcChannels, 3>(src, dst, count); break;
+        default: convertChannelsFixed<T, SrcChannels, 4>(src, dst, count); break;
+    }
+}
+
+template <typename T>
+void convertChannels(const T* src, int srcChannels, T* dst, int dstChannels, size_t count) {
+    if (srcChannels == dstChannels) {
+        memcpy(dst, src, count * srcChannels * sizeof(T));
+        return;
+    }
+    switch (srcChannels) {
+        case 1: convertChannelsFrom<T, 1>(src, dst, dstChannels, count); break;
+        case 2: convertChannelsFrom<T, 2>(src, dst, dstChannels, count); break;
+        case 3: convertChannelsFrom<T, 3>(src, dst, dstChannels, count); break;
+        default: convertChannelsFrom<T, 4>(src, dst, dstChannels, count); break;
+    }
+}
+
+// Drops 16-bit samples to 8 bits by keeping the high byte, like stbi_load does.
+void narrowTo8Bit(const uint16_t* src, unsigned char* dst, size_t count) {
+    size_t i = 0;
+#ifdef SLICER_SSE2
+    for (; i + 16 <= count; i += 16) {
+        __m128i lo = _mm_srli_epi16(_mm_loadu_si128((const __m128i*)(src + i)), 8);
+        __m128i hi = _mm_srli_epi16(_mm_loadu_si128((const __m128i*)(src + i + 8)), 8);
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(lo, hi));
+    }
+#endif
+    for (; i < count; i++) dst[i] = (unsigned char)(src[i] >> 8);
+}
+
+// Converts a pixel buffer to dstChannels at 8 bits, or at the source depth if
+// keep16Bit is set. 16-bit buffers hold native-endian uint16_t samples.
+void convertPixels(const unsigned char* src, int srcChannels, int srcBitDepth,
+                   int dstChannels, bool keep16Bit, size_t count, std::vector<unsigned char>& dst) {
+    if (srcBitDepth == 16 && keep16Bit) {
+        dst.resize(count * dstChannels * 2);
+        convertChannels((const uint16_t*)src, srcChannels, (uint16_t*)dst.data(), dstChannels, count);
+        return;
+    }
+
+    dst.resize(count * dstChannels);
+    if (srcBitDepth == 16) {
+        std::vector<unsigned char> narrowed(count * srcChannels);
+        narrowTo8Bit((const uint16_t*)src, narrowed.data(), narrowed.size());
+        convertChannels(narrowed.data(), srcChannels, dst.data(), dstChannels, count);
+    } else {
+        convertChannels(src, srcChannels, dst.data(), dstChannels, count);
+    }
+}
+
 struct ImageTexture {
     GLuint textureID = 0;
     int width = 0;
     int height = 0;
     int channels = 0;
+    int bitDepth = 8;
     unsigned char* data = nullptr;
 
     ~ImageTexture() {
@@ -38,7 +177,9 @@ struct ImageTexture {
         if (textureID) glDeleteTextures(1, &textureID);
     }
 
-    bool loadFromFile(const char* path) {
+    int bytesPerPixel() const { return channels * bitDepth / 8; }
+
+    void release() {
         if (data) {
             stbi_image_free(data);
             data = nullptr;
@@ -47,10 +188,26 @@ struct ImageTexture {
             glDeleteTextures(1, &textureID);
             textureID = 0;
         }
+    }
 
-        data = stbi_load(path, &width, &height, &channels, 0);
+    bool loadFromFile(const char* path) {
+        release();
+
+        // 16-bit PNGs keep their full precision instead of being cut to 8 bits.
+        if (stbi_is_16_bit(path)) {
+            data = (unsigned char*)stbi_load_16(path, &width, &height, &channels, 0);
+            bitDepth = 16;
+        } else {
+            data = stbi_load(path, &width, &height, &channels, 0);
+            bitDepth = 8;
+        }
         if (!data) return false;
+        return upload();
+    }
 
+    // Creates the preview texture from data, which must be malloc-compatible
+    // since it is released with stbi_image_free.
+    bool upload() {
         glGenTextures(1, &textureID);
         glBindTexture(GL_TEXTURE_2D, textureID);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
@@ -58,13 +215,45 @@ struct ImageTexture {
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-        GLenum format = (channels == 4) ? GL_RGBA : (channels == 3) ? GL_RGB : GL_RED;
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+        static const GLenum formats[] = {GL_RED, GL_RG, GL_RGB, GL_RGBA};
+        static const GLint formats8[] = {GL_R8, GL_RG8, GL_RGB8, GL_RGBA8};
+        static const GLint formats16[] = {GL_R16, GL_RG16, GL_RGB16, GL_RGBA16};
+        GLenum type = (bitDepth == 16) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_BYTE;
+
+        // Rows of 1-3 channel images are not 4-byte aligned in general.
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
+        if (channels >= 3) {
+            glTexImage2D(GL_TEXTURE_2D, 0, (bitDepth == 16 ? formats16 : formats8)[channels - 1],
+                         width, height, 0, formats[channels - 1], type, data);
+            return true;
+        }
+
+        // Grey and grey+alpha stay one or two samples per pixel on the GPU and
+        // are swizzled back to grey when sampled.
+        while (glGetError() != GL_NO_ERROR) {}
+        GLint swizzle[] = {GL_RED, GL_RED, GL_RED, (channels == 2) ? GL_GREEN : GL_ONE};
+        glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+        if (glGetError() == GL_NO_ERROR) {
+            glTexImage2D(GL_TEXTURE_2D, 0, (bitDepth == 16 ? formats16 : formats8)[channels - 1],
+                         width, height, 0, formats[channels - 1], type, data);
+            return true;
+        }
+
+        // No texture swizzle (pre-3.3 context): expand to 8-bit RGBA for the preview only.
+        std::vector<unsigned char> expanded;
+        convertPixels(data, channels, bitDepth, 4, false, (size_t)width * height, expanded);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, expanded.data());
         return true;
     }
 };
 
+enum PngFormat {
+    PngFormat_Truecolor = 0,
+    PngFormat_IndexedLossless,
+    PngFormat_IndexedQuantized,
+};
+
 struct SpritesheetConfig {
     char inputPath[512] = "";
     char outputDir[256] = "output";
@@ -75,6 +264,10 @@ struct SpritesheetConfig {
     int marginY = 0;
     int spacingX = 0;
     int spacingY = 0;
+    bool exportHalfScale = false;
+    bool exportQuarterScale = false;
+    int pngFormat = PngFormat_Truecolor;
+    int outputChannels = 0;  // 0 keeps the source channel count
     bool showGrid = true;
     float zoomLevel = 1.0f;
     ImVec2 panOffset = ImVec2(0, 0);
@@ -165,6 +358,15 @@ void Tooltip(const char* desc) {
     }
 }
 
+std::string spriteBaseName(const SpritesheetConfig& config, const std::map<int, std::string>& spriteNames,
+                           int spriteIndex) {
+    auto it = spriteNames.find(spriteIndex);
+    if (it != spriteNames.end() && !it->second.empty()) {
+        return it->second;
+    }
+    return std::string(config.spritePrefix) + "_" + std::to_string(spriteIndex);
+}
+
 void extractSprite(const unsigned char* imageData, int imageWidth, int imageHeight, int channels,
                    int startX, int startY, int spriteWidth, int spriteHeight,
                    std::vector<unsigned char>& spriteData) {
@@ -192,6 +394,516 @@ void extractSprite(const unsigned char* imageData, int imageWidth, int imageHeig
     }
 }
 
+// Output scales written by extractSelectedSprites, largest first. Variants are
+// produced by repeated halving, so 0.25x goes through an unwritten 0.5x step
+// when only the quarter scale is ticked.
+std::vector<float> exportScales(const SpritesheetConfig& config) {
+    std::vector<float> scales = {1.0f};
+    if (config.exportHalfScale) scales.push_back(0.5f);
+    if (config.exportQuarterScale) scales.push_back(0.25f);
+    return scales;
+}
+
+// Size of one sprite side after halving down to scale, matching downscaleHalf.
+int scaledSpriteSize(int size, float scale) {
+    for (float current = 1.0f; current > scale; current *= 0.5f) {
+        size = std::max(1, (size + 1) / 2);
+    }
+    return size;
+}
+
+std::string scaleSuffix(float scale) {
+    if (scale == 1.0f) return "";
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "@%gx", scale);
+    return buffer;
+}
+
+// Halves a sprite with a 2x2 box filter. Colour is averaged premultiplied by
+// alpha so fully transparent pixels don't bleed their colour into the edges;
+// odd sizes round up and reuse the last row/column.
+void downscaleHalf(const unsigned char* src, int width, int height, int channels,
+                   std::vector<unsigned char>& dst, int& dstWidth, int& dstHeight) {
+    dstWidth = std::max(1, (width + 1) / 2);
+    dstHeight = std::max(1, (height + 1) / 2);
+    dst.resize(dstWidth * dstHeight * channels);
+
+    int alphaIndex = (channels == 4) ? 3 : (channels == 2) ? 1 : -1;
+
+    for (int y = 0; y < dstHeight; y++) {
+        const unsigned char* row0 = src + (2 * y) * width * channels;
+        const unsigned char* row1 = src + std::min(2 * y + 1, height - 1) * width * channels;
+        unsigned char* out = dst.data() + y * dstWidth * channels;
+        int x = 0;
+
+#ifdef SLICER_SSE2
+        if (channels == 4) {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128 colorMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+            const __m128 quarter = _mm_set1_ps(0.25f);
+            const __m128 half = _mm_set1_ps(0.5f);
+
+            // Each iteration reads two adjacent RGBA pixels from both rows.
+            for (; 2 * x + 1 < width; x++) {
+                __m128i top = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(row0 + 8 * x)), zero);
+                __m128i bottom = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(row1 + 8 * x)), zero);
+
+                __m128 p0 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(top, zero));
+                __m128 p1 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(top, zero));
+                __m128 p2 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(bottom, zero));
+                __m128 p3 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(bottom, zero));
+
+                __m128 a0 = _mm_shuffle_ps(p0, p0, _MM_SHUFFLE(3, 3, 3, 3));
+                __m128 a1 = _mm_shuffle_ps(p1, p1, _MM_SHUFFLE(3, 3, 3, 3));
+                __m128 a2 = _mm_shuffle_ps(p2, p2, _MM_SHUFFLE(3, 3, 3, 3));
+                __m128 a3 = _mm_shuffle_ps(p3, p3, _MM_SHUFFLE(3, 3, 3, 3));
+
+                __m128 alphaSum = _mm_add_ps(_mm_add_ps(a0, a1), _mm_add_ps(a2, a3));
+                __m128 premulSum = _mm_add_ps(_mm_add_ps(_mm_mul_ps(p0, a0), _mm_mul_ps(p1, a1)),
+                                              _mm_add_ps(_mm_mul_ps(p2, a2), _mm_mul_ps(p3, a3)));
+
+                // 0/0 for fully transparent blocks is masked back to zero.
+                __m128 color = _mm_and_ps(_mm_div_ps(premulSum, alphaSum),
+                                          _mm_cmpgt_ps(alphaSum, _mm_setzero_ps()));
+                __m128 alpha = _mm_mul_ps(alphaSum, quarter);
+                __m128 result = _mm_or_ps(_mm_and_ps(colorMask, color), _mm_andnot_ps(colorMask, alpha));
+
+                __m128i packed = _mm_cvttps_epi32(_mm_add_ps(result, half));
+                packed = _mm_packs_epi32(packed, packed);
+                packed = _mm_packus_epi16(packed, packed);
+                int pixel = _mm_cvtsi128_si32(packed);
+                memcpy(out + 4 * x, &pixel, 4);
+            }
+        }
+#endif
+
+        for (; x < dstWidth; x++) {
+            const unsigned char* samples[4] = {
+                row0 + (2 * x) * channels,
+                row0 + std::min(2 * x + 1, width - 1) * channels,
+                row1 + (2 * x) * channels,
+                row1 + std::min(2 * x + 1, width - 1) * channels,
+            };
+            unsigned char* dstPixel = out + x * channels;
+
+            if (alphaIndex < 0) {
+                for (int c = 0; c < channels; c++) {
+                    int sum = samples[0][c] + samples[1][c] + samples[2][c] + samples[3][c];
+                    dstPixel[c] = (unsigned char)((sum + 2) / 4);
+                }
+                continue;
+            }
+
+            int alphaSum = 0;
+            for (int i = 0; i < 4; i++) alphaSum += samples[i][alphaIndex];
+
+            for (int c = 0; c < channels; c++) {
+                if (c == alphaIndex) {
+                    dstPixel[c] = (unsigned char)((alphaSum + 2) / 4);
+                } else if (alphaSum == 0) {
+                    dstPixel[c] = 0;
+                } else {
+                    int premulSum = 0;
+                    for (int i = 0; i < 4; i++) premulSum += samples[i][c] * samples[i][alphaIndex];
+                    dstPixel[c] = (unsigned char)((premulSum + alphaSum / 2) / alphaSum);
+                }
+            }
+        }
+    }
+}
+
+// Pixels are compared and stored as packed 0xAABBGGRR, whatever the source layout.
+static uint32_t packColor(const unsigned char* pixel, int channels) {
+    switch (channels) {
+        case 1: return 0xFF000000u | pixel[0] * 0x010101u;
+        case 2: return ((uint32_t)pixel[1] << 24) | pixel[0] * 0x010101u;
+        case 3: return 0xFF000000u | ((uint32_t)pixel[2] << 16) | ((uint32_t)pixel[1] << 8) | pixel[0];
+        default: return ((uint32_t)pixel[3] << 24) | ((uint32_t)pixel[2] << 16) | ((uint32_t)pixel[1] << 8) | pixel[0];
+    }
+}
+
+static int colorChannel(uint32_t color, int c) {
+    return (color >> (8 * c)) & 0xFF;
+}
+
+// Open-addressing color -> count table; far cheaper than std::unordered_map
+// for the millions of lookups a large sheet needs.
+class ColorHistogram {
+public:
+    ColorHistogram() : keys(1024), counts(1024, 0) {}
+
+    void add(uint32_t color) {
+        size_t slot = find(color);
+        if (counts[slot] == 0) {
+            keys[slot] = color;
+            if (++used * 2 > keys.size()) {
+                counts[slot] = 1;
+                grow();
+                return;
+            }
+        }
+        counts[slot]++;
+    }
+
+    size_t size() const { return used; }
+
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (size_t i = 0; i < keys.size(); i++) {
+            if (counts[i]) fn(keys[i], counts[i]);
+        }
+    }
+
+private:
+    size_t find(uint32_t color) const {
+        // Fibonacci hashing: the top bits of the product depend on every
+        // channel, unlike the low bits which only see red and part of green.
+        size_t mask = keys.size() - 1;
+        size_t slot = (uint32_t)(color * 2654435761u) >> shift;
+        while (counts[slot] != 0 && keys[slot] != color) slot = (slot + 1) & mask;
+        return slot;
+    }
+
+    void grow() {
+        std::vector<uint32_t> oldKeys;
+        std::vector<uint32_t> oldCounts;
+        oldKeys.swap(keys);
+        oldCounts.swap(counts);
+        keys.assign(oldKeys.size() * 2, 0);
+        counts.assign(oldKeys.size() * 2, 0);
+        shift--;
+        for (size_t i = 0; i < oldKeys.size(); i++) {
+            if (!oldCounts[i]) continue;
+            size_t slot = find(oldKeys[i]);
+            keys[slot] = oldKeys[i];
+            counts[slot] = oldCounts[i];
+        }
+    }
+
+    std::vector<uint32_t> keys;
+    std::vector<uint32_t> counts;
+    size_t used = 0;
+    int shift = 22;  // 32 - log2(table size)
+};
+
+struct SheetPalette {
+    std::vector<uint32_t> colors;
+    std::unordered_map<uint32_t, uint8_t> lookup;
+    std::unordered_map<uint32_t, uint8_t> nearestCache;
+    int sourceColors = 0;
+    bool exact = false;
+    bool mergeTransparent = false;
+    int bitDepth = 8;
+
+    // Returns the entry holding color, or -1 if there is none and allowNearest
+    // is false. Otherwise the closest entry is returned, e.g. for blended edge
+    // colours in downscaled variants.
+    int indexOf(uint32_t color, bool allowNearest) {
+        auto it = lookup.find(color);
+        if (it != lookup.end()) return it->second;
+        if (!allowNearest) return -1;
+
+        auto cached = nearestCache.find(color);
+        if (cached != nearestCache.end()) return cached->second;
+
+        int best = 0;
+        int bestDistance = INT32_MAX;
+        for (size_t i = 0; i < colors.size(); i++) {
+            int distance = 0;
+            for (int c = 0; c < 4; c++) {
+                int d = colorChannel(color, c) - colorChannel(colors[i], c);
+                distance += d * d;
+            }
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                best = (int)i;
+            }
+        }
+        nearestCache[color] = (uint8_t)best;
+        return best;
+    }
+};
+
+// Reduces a histogram to at most maxColors entries by median cut: the box with
+// the widest channel range is split at its weighted median until none remain.
+static std::vector<uint32_t> medianCut(std::vector<std::pair<uint32_t, uint32_t>> entries, size_t maxColors) {
+    struct Box { size_t begin, end; int channel, range; };
+
+    auto measure = [&](size_t begin, size_t end) {
+        Box box = {begin, end, 0, -1};
+        for (int c = 0; c < 4; c++) {
+            int lo = 255, hi = 0;
+            for (size_t i = begin; i < end; i++) {
+                lo = std::min(lo, colorChannel(entries[i].first, c));
+                hi = std::max(hi, colorChannel(entries[i].first, c));
+            }
+            if (hi - lo > box.range) {
+                box.range = hi - lo;
+                box.channel = c;
+            }
+        }
+        return box;
+    };
+
+    std::vector<Box> boxes = {measure(0, entries.size())};
+    while (boxes.size() < maxColors) {
+        auto widest = std::max_element(boxes.begin(), boxes.end(),
+                                       [](const Box& a, const Box& b) { return a.range < b.range; });
+        if (widest->range <= 0) break;
+
+        Box box = *widest;
+        std::sort(entries.begin() + box.begin, entries.begin() + box.end,
+                  [&](const auto& a, const auto& b) {
+                      return colorChannel(a.first, box.channel) < colorChannel(b.first, box.channel);
+                  });
+
+        uint64_t total = 0;
+        for (size_t i = box.begin; i < box.end; i++) total += entries[i].second;
+        uint64_t running = 0;
+        size_t split = box.begin + 1;
+        for (size_t i = box.begin; i < box.end - 1; i++) {
+            running += entries[i].second;
+            split = i + 1;
+            if (running * 2 >= total) break;
+        }
+
+        *widest = measure(box.begin, split);
+        boxes.push_back(measure(split, box.end));
+    }
+
+    std::vector<uint32_t> palette;
+    for (const Box& box : boxes) {
+        double sums[4] = {0, 0, 0, 0};
+        double weight = 0;
+        for (size_t i = box.begin; i < box.end; i++) {
+            for (int c = 0; c < 4; c++) sums[c] += colorChannel(entries[i].first, c) * (double)entries[i].second;
+            weight += entries[i].second;
+        }
+        uint32_t color = 0;
+        for (int c = 0; c < 4; c++) color |= (uint32_t)(sums[c] / weight + 0.5) << (8 * c);
+        palette.push_back(color);
+    }
+    return palette;
+}
+
+// Builds one palette shared by every sprite of the sheet. Sheets with at most
+// 256 distinct colors get an exact palette; others are median-cut when
+// quantizing is allowed. Returns false if lossless output is impossible.
+bool buildSheetPalette(const unsigned char* pixels, size_t pixelCount, int channels,
+                       bool allowQuantize, bool includePadding, uint32_t paddingColor,
+                       SheetPalette& palette) {
+    ColorHistogram histogram;
+    for (size_t i = 0; i < pixelCount; i++) {
+        uint32_t color = packColor(pixels + i * channels, channels);
+        // Invisible pixels all look the same, so let them share one entry when quantizing.
+        if (allowQuantize && (color >> 24) == 0) color = 0;
+        histogram.add(color);
+    }
+    // Cells reaching past the image edge are padded; paddingColor is that fill after conversion.
+    if (includePadding) {
+        if (allowQuantize && (paddingColor >> 24) == 0) paddingColor = 0;
+        histogram.add(paddingColor);
+    }
+
+    palette = SheetPalette();
+    palette.mergeTransparent = allowQuantize;
+    palette.sourceColors = (int)histogram.size();
+    palette.exact = histogram.size() <= 256;
+
+    if (palette.exact) {
+        histogram.forEach([&](uint32_t color, uint32_t) { palette.colors.push_back(color); });
+    } else if (allowQuantize) {
+        std::vector<std::pair<uint32_t, uint32_t>> entries;
+        entries.reserve(histogram.size());
+        histogram.forEach([&](uint32_t color, uint32_t count) { entries.emplace_back(color, count); });
+        palette.colors = medianCut(std::move(entries), 256);
+    } else {
+        return false;
+    }
+
+    // Translucent entries first keeps the tRNS chunk as short as possible.
+    std::sort(palette.colors.begin(), palette.colors.end(), [](uint32_t a, uint32_t b) {
+        return std::make_pair((a >> 24) == 255, a) < std::make_pair((b >> 24) == 255, b);
+    });
+    palette.colors.erase(std::unique(palette.colors.begin(), palette.colors.end()), palette.colors.end());
+    for (size_t i = 0; i < palette.colors.size(); i++) palette.lookup[palette.colors[i]] = (uint8_t)i;
+
+    size_t n = palette.colors.size();
+    palette.bitDepth = (n <= 2) ? 1 : (n <= 4) ? 2 : (n <= 16) ? 4 : 8;
+    return true;
+}
+
+static void appendBigEndian(std::vector<unsigned char>& out, uint32_t value) {
+    out.push_back((value >> 24) & 0xFF);
+    out.push_back((value >> 16) & 0xFF);
+    out.push_back((value >> 8) & 0xFF);
+    out.push_back(value & 0xFF);
+}
+
+static uint32_t pngCrc32(const unsigned char* data, size_t len) {
+    static uint32_t table[256];
+    static bool initialized = false;
+    if (!initialized) {
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[n] = c;
+        }
+        initialized = true;
+    }
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; i++) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+static void appendPngChunk(std::vector<unsigned char>& out, const char* type, const unsigned char* data, size_t len) {
+    appendBigEndian(out, (uint32_t)len);
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    if (len) out.insert(out.end(), data, data + len);
+    appendBigEndian(out, pngCrc32(out.data() + start, len + 4));
+}
+
+// Assembles a PNG from rows that already carry their filter byte. A palette
+// adds PLTE/tRNS chunks for color type 3. Used for the layouts stb_image_write
+// can't produce: indexed and 16-bit images.
+static bool writePngFile(const std::string& path, int width, int height, int bitDepth, int colorType,
+                         std::vector<unsigned char>& rows, const SheetPalette* palette) {
+    int compressedLen = 0;
+    unsigned char* compressed = stbi_zlib_compress(rows.data(), (int)rows.size(), &compressedLen,
+                                                   stbi_write_png_compression_level);
+    if (!compressed) return false;
+
+    std::vector<unsigned char> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+    std::vector<unsigned char> header;
+    appendBigEndian(header, width);
+    appendBigEndian(header, height);
+    header.insert(header.end(), {(unsigned char)bitDepth, (unsigned char)colorType, 0, 0, 0});
+    appendPngChunk(png, "IHDR", header.data(), header.size());
+
+    if (palette) {
+        std::vector<unsigned char> plte;
+        std::vector<unsigned char> trns;
+        for (uint32_t color : palette->colors) {
+            for (int c = 0; c < 3; c++) plte.push_back(colorChannel(color, c));
+            if ((color >> 24) < 255) trns.push_back(color >> 24);
+        }
+        appendPngChunk(png, "PLTE", plte.data(), plte.size());
+        if (!trns.empty()) appendPngChunk(png, "tRNS", trns.data(), trns.size());
+    }
+
+    appendPngChunk(png, "IDAT", compressed, compressedLen);
+    STBIW_FREE(compressed);
+    appendPngChunk(png, "IEND", nullptr, 0);
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    file.write((const char*)png.data(), png.size());
+    return file.good();
+}
+
+// Writes palette indices as a color-type 3 PNG, packing rows to the palette's
+// bit depth.
+bool writeIndexedPng(const std::string& path, int width, int height,
+                     const std::vector<uint8_t>& indices, const SheetPalette& palette) {
+    int bitDepth = palette.bitDepth;
+    int perByte = 8 / bitDepth;
+    size_t rowBytes = (width + perByte - 1) / perByte;
+
+    std::vector<unsigned char> raw((rowBytes + 1) * height, 0);
+    for (int y = 0; y < height; y++) {
+        unsigned char* row = raw.data() + y * (rowBytes + 1) + 1;
+        for (int x = 0; x < width; x++) {
+            int shift = 8 - bitDepth * (x % perByte + 1);
+            row[x / perByte] |= indices[y * width + x] << shift;
+        }
+    }
+    return writePngFile(path, width, height, bitDepth, 3, raw, &palette);
+}
+
+// Writes native-endian 16-bit samples as a 16-bit grey/grey+alpha/RGB/RGBA PNG.
+bool write16BitPng(const std::string& path, int width, int height, int channels,
+                   const std::vector<unsigned char>& pixels) {
+    static const int colorTypes[] = {0, 4, 2, 6};
+    const uint16_t* samples = (const uint16_t*)pixels.data();
+    size_t rowSamples = (size_t)width * channels;
+
+    std::vector<unsigned char> raw((rowSamples * 2 + 1) * height, 0);
+    for (int y = 0; y < height; y++) {
+        unsigned char* row = raw.data() + y * (rowSamples * 2 + 1) + 1;
+        for (size_t i = 0; i < rowSamples; i++) {
+            uint16_t value = samples[y * rowSamples + i];
+            row[2 * i] = value >> 8;
+            row[2 * i + 1] = value & 0xFF;
+        }
+    }
+    return writePngFile(path, width, height, 16, colorTypes[channels - 1], raw, nullptr);
+}
+
+// Maps a sprite to palette indices. Returns the number of pixels whose palette
+// color differs from the source pixel, so lossless output can be verified.
+int indexSprite(const std::vector<unsigned char>& spriteData, int channels,
+                SheetPalette& palette, bool allowNearest, std::vector<uint8_t>& indices) {
+    size_t count = spriteData.size() / channels;
+    indices.resize(count);
+
+    int mismatches = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t color = packColor(spriteData.data() + i * channels, channels);
+        if (palette.mergeTransparent && (color >> 24) == 0) color = 0;
+        int index = palette.indexOf(color, allowNearest);
+        if (index < 0 || palette.colors[index] != color) mismatches++;
+        indices[i] = (uint8_t)std::max(0, index);
+    }
+    return mismatches;
+}
+
+// Writes one sprite in the configured PNG format. With a palette, mismatches
+// counts pixels whose palette color differs from the sprite's.
+bool writeSpritePng(const std::string& path, int width, int height, int channels,
+                    const std::vector<unsigned char>& spriteData, SheetPalette* palette, bool allowNearest,
+                    std::vector<uint8_t>& indexScratch, int& mismatches) {
+    if (!palette) {
+        return stbi_write_png(path.c_str(), width, height, channels, spriteData.data(), width * channels) != 0;
+    }
+    mismatches += indexSprite(spriteData, channels, *palette, allowNearest, indexScratch);
+    return writeIndexedPng(path, width, height, indexScratch, *palette);
+}
+
+// Converts and writes one sprite cropped from a sheet with srcChannels samples
+// of srcBitDepth bits. Truecolor output of a 16-bit sheet stays 16-bit; all
+// other output is 8-bit with outputChannels. Shared by the Extract button and
+// watch mode. If eightBit is non-null it receives the 8-bit pixels, which the
+// scaled variants are built from.
+bool writeCroppedSprite(const std::string& path, int width, int height,
+                        const std::vector<unsigned char>& cropped, int srcChannels, int srcBitDepth,
+                        int outputChannels, SheetPalette* palette, bool allowNearest,
+                        std::vector<unsigned char>& converted, std::vector<uint8_t>& indexScratch,
+                        int& mismatches, const std::vector<unsigned char>** eightBit) {
+    size_t pixelCount = (size_t)width * height;
+    const std::vector<unsigned char>* pixels = &cropped;
+    bool written;
+
+    if (srcBitDepth == 16 && !palette) {
+        convertPixels(cropped.data(), srcChannels, 16, outputChannels, true, pixelCount, converted);
+        written = write16BitPng(path, width, height, outputChannels, converted);
+        if (!eightBit) return written;
+        convertPixels(cropped.data(), srcChannels, 16, outputChannels, false, pixelCount, converted);
+        pixels = &converted;
+    } else {
+        if (srcBitDepth != 8 || srcChannels != outputChannels) {
+            convertPixels(cropped.data(), srcChannels, srcBitDepth, outputChannels, false, pixelCount, converted);
+            pixels = &converted;
+        }
+        written = writeSpritePng(path, width, height, outputChannels, *pixels, palette, allowNearest,
+                                 indexScratch, mismatches);
+    }
+
+    if (eightBit) *eightBit = pixels;
+    return written;
+}
+
 int extractSelectedSprites(const SpritesheetConfig& config, const ImageTexture& texture,
                           const std::vector<bool>& selectedSprites,
                           const std::map<int, std::string>& spriteNames,
@@ -214,8 +926,47 @@ int extractSelectedSprites(const SpritesheetConfig& config, const ImageTexture&
     int spritesPerRow = std::max(1, (availableWidth + config.spacingX) / (config.spriteWidth + config.spacingX));
     int spritesPerColumn = std::max(1, (availableHeight + config.spacingY) / (config.spriteHeight + config.spacingY));
 
+    int outputChannels = config.outputChannels ? config.outputChannels : texture.channels;
+    bool convert = outputChannels != texture.channels || texture.bitDepth != 8;
+
+    SheetPalette palette;
+    bool indexed = config.pngFormat != PngFormat_Truecolor;
+    bool lossless = config.pngFormat == PngFormat_IndexedLossless;
+    if (indexed) {
+        int gridWidth = config.marginX + spritesPerRow * (config.spriteWidth + config.spacingX) - config.spacingX;
+        int gridHeight = config.marginY + spritesPerColumn * (config.spriteHeight + config.spacingY) - config.spacingY;
+        bool overrunsImage = gridWidth > texture.width || gridHeight > texture.height;
+
+        // The palette is built from the sheet as it will be written, not as loaded.
+        std::vector<unsigned char> converted;
+        size_t pixelCount = (size_t)texture.width * texture.height;
+        if (convert) {
+            convertPixels(texture.data, texture.channels, texture.bitDepth, outputChannels, false, pixelCount, converted);
+        }
+
+        // extractSprite pads with zeroed source pixels, which may turn opaque once converted.
+        const unsigned char zeroPixel[8] = {};
+        std::vector<unsigned char> padding;
+        convertPixels(zeroPixel, texture.channels, texture.bitDepth, outputChannels, false, 1, padding);
+
+        if (!buildSheetPalette(convert ? converted.data() : texture.data, pixelCount, outputChannels,
+                               !lossless, overrunsImage, packColor(padding.data(), outputChannels), palette)) {
+            statusMsg = "Error: Sheet has " + std::to_string(palette.sourceColors) +
+                        " colors; lossless indexed PNG supports at most 256";
+            return 0;
+        }
+    }
+
     int extractedCount = 0;
+    int failedVariants = 0;
+    int mismatchedPixels = 0;
+    int approximatedPixels = 0;
+    std::vector<uint8_t> indexScratch;
+    std::vector<float> scales = exportScales(config);
     std::vector<unsigned char> spriteData;
+    std::vector<unsigned char> convertedData;
+    std::vector<unsigned char> scaledData;
+    std::vector<unsigned char> nextScaledData;
 
     for (int row = 0; row < spritesPerColumn; row++) {
         for (int col = 0; col < spritesPerRow; col++) {
@@ -226,27 +977,62 @@ int extractSelectedSprites(const SpritesheetConfig& config, const ImageTexture&
             int startX = config.marginX + col * (config.spriteWidth + config.spacingX);
             int startY = config.marginY + row * (config.spriteHeight + config.spacingY);
 
-            extractSprite(texture.data, texture.width, texture.height, texture.channels,
+            // extractSprite only copies bytes, so whole pixels of any depth move as one unit.
+            extractSprite(texture.data, texture.width, texture.height, texture.bytesPerPixel(),
                          startX, startY, config.spriteWidth, config.spriteHeight, spriteData);
 
-            std::string filename;
-            auto it = spriteNames.find(spriteIndex);
-            if (it != spriteNames.end() && !it->second.empty()) {
-                filename = it->second + ".png";
-            } else {
-                filename = std::string(config.spritePrefix) + "_" + std::to_string(spriteIndex) + ".png";
-            }
-
-            std::string outputPath = std::string(config.outputDir) + "/" + filename;
+            std::string baseName = spriteBaseName(config, spriteNames, spriteIndex);
+            std::string outputPath = std::string(config.outputDir) + "/" + baseName + ".png";
 
-            if (stbi_write_png(outputPath.c_str(), config.spriteWidth, config.spriteHeight,
-                              texture.channels, spriteData.data(), config.spriteWidth * texture.channels)) {
+            const std::vector<unsigned char>* sprite = nullptr;
+            if (writeCroppedSprite(outputPath, config.spriteWidth, config.spriteHeight, spriteData,
+                                   texture.channels, texture.bitDepth, outputChannels,
+                                   indexed ? &palette : nullptr, !lossless, convertedData, indexScratch,
+                                   mismatchedPixels, scales.size() > 1 ? &sprite : nullptr)) {
                 extractedCount++;
             }
+
+            // Smaller variants are built from the tile just cropped, while it is still in cache.
+            // They are always 8-bit.
+            const std::vector<unsigned char>* source = sprite;
+            int scaledWidth = config.spriteWidth;
+            int scaledHeight = config.spriteHeight;
+            for (float scale = 0.5f; scale >= scales.back(); scale *= 0.5f) {
+                downscaleHalf(source->data(), scaledWidth, scaledHeight, outputChannels,
+                              nextScaledData, scaledWidth, scaledHeight);
+                std::swap(scaledData, nextScaledData);
+                source = &scaledData;
+
+                if (std::find(scales.begin(), scales.end(), scale) == scales.end()) continue;
+
+                std::string scaledPath = std::string(config.outputDir) + "/" + baseName + scaleSuffix(scale) + ".png";
+                if (!writeSpritePng(scaledPath, scaledWidth, scaledHeight, outputChannels,
+                                    scaledData, indexed ? &palette : nullptr, true,
+                                    indexScratch, approximatedPixels)) {
+                    failedVariants++;
+                }
+            }
         }
     }
 
-    statusMsg = "Successfully extracted " + std::to_string(extractedCount) + " sprites!";
+    statusMsg = "Successfully extracted " + std::to_string(extractedCount) + " sprites";
+    statusMsg += (scales.size() > 1) ? " at " + std::to_string(scales.size()) + " scales!" : "!";
+    if (failedVariants) {
+        statusMsg += "\nError: Failed to write " + std::to_string(failedVariants) + " scaled variants";
+    }
+    if (indexed) {
+        statusMsg += "\nPalette: " + std::to_string(palette.colors.size()) + " colors (" +
+                     std::to_string(palette.bitDepth) + "-bit) from " + std::to_string(palette.sourceColors);
+        if (lossless) {
+            statusMsg += mismatchedPixels ? ", " + std::to_string(mismatchedPixels) + " pixels NOT lossless!"
+                                          : ", verified lossless";
+        }
+        // Downscaling blends colors, so scaled variants can't be lossless; say how much was approximated.
+        if (approximatedPixels) {
+            statusMsg += "\n" + std::to_string(approximatedPixels) +
+                         " pixels in scaled variants mapped to the nearest palette color";
+        }
+    }
     return extractedCount;
 }
 
@@ -302,23 +1088,861 @@ void drawGrid(ImDrawList* drawList, ImVec2 imagePos, ImVec2 imageSize,
     }
 }
 
+template <size_t N>
+void copyString(char (&dst)[N], const std::string& src) {
+    strncpy(dst, src.c_str(), N - 1);
+    dst[N - 1] = '\0';
+}
+
+static std::string trimString(const std::string& str) {
+    size_t begin = str.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) return "";
+    size_t end = str.find_last_not_of(" \t\r");
+    return str.substr(begin, end - begin + 1);
+}
+
+// Reads a per-sheet "<image>.slicer" file of key=value lines, e.g.
+//   spriteWidth=32
+//   spriteHeight=32
+//   name.4=hero_idle
+// Keys mirror SpritesheetConfig; "name.<index>" entries rename single sprites.
+bool loadSliceConfig(const fs::path& path, SpritesheetConfig& config,
+                     std::map<int, std::string>& spriteNames) {
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        line = trimString(line);
+        size_t eq = line.find('=');
+        if (line.empty() || line[0] == '#' || eq == std::string::npos) continue;
+
+        std::string key = trimString(line.substr(0, eq));
+        std::string value = trimString(line.substr(eq + 1));
+
+        if (key == "spriteWidth") config.spriteWidth = std::atoi(value.c_str());
+        else if (key == "spriteHeight") config.spriteHeight = std::atoi(value.c_str());
+        else if (key == "marginX") config.marginX = std::atoi(value.c_str());
+        else if (key == "marginY") config.marginY = std::atoi(value.c_str());
+        else if (key == "spacingX") config.spacingX = std::atoi(value.c_str());
+        else if (key == "spacingY") config.spacingY = std::atoi(value.c_str());
+        else if (key == "channels") config.outputChannels = std::clamp(std::atoi(value.c_str()), 0, 4);
+        else if (key == "outputDir") copyString(config.outputDir, value);
+        else if (key == "spritePrefix") copyString(config.spritePrefix, value);
+        else if (key.rfind("name.", 0) == 0) spriteNames[std::atoi(key.c_str() + 5)] = value;
+    }
+
+    return config.spriteWidth > 0 && config.spriteHeight > 0;
+}
+
+// Bounded multi-producer/multi-consumer queue linking the watch pipeline stages.
+// close() lets consumers drain what is left, after which pop() returns false.
+template <typename T>
+class BlockingQueue {
+public:
+    explicit BlockingQueue(size_t capacity) : capacity(capacity) {}
+
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [&] { return closed || items.size() < capacity; });
+        if (closed) return false;
+        items.push_back(std::move(item));
+        peak = std::max(peak, items.size());
+        notEmpty.notify_one();
+        return true;
+    }
+
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [&] { return closed || !items.empty(); });
+        if (items.empty()) return false;
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+
+    size_t depth() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return items.size();
+    }
+
+    size_t peakDepth() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return peak;
+    }
+
+private:
+    mutable std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::deque<T> items;
+    size_t capacity;
+    size_t peak = 0;
+    bool closed = false;
+};
+
+using SteadyClock = std::chrono::steady_clock;
+
+static double elapsedMs(SteadyClock::time_point since) {
+    return std::chrono::duration<double, std::milli>(SteadyClock::now() - since).count();
+}
+
+struct SheetJob {
+    fs::path imagePath;
+    SpritesheetConfig config;
+    std::map<int, std::string> spriteNames;
+    SteadyClock::time_point changedAt;
+
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    int bitDepth = 8;
+    std::unique_ptr<unsigned char, void (*)(void*)> pixels{nullptr, stbi_image_free};
+
+    std::vector<std::string> tilePaths;
+    std::vector<std::vector<unsigned char>> tiles;
+
+    double decodeMs = 0.0;
+    double sliceMs = 0.0;
+    double encodeMs = 0.0;
+};
+
+struct WatchStats {
+    std::mutex mutex;
+    int sheets = 0;
+    int sprites = 0;
+    int failures = 0;
+    double totalLatencyMs = 0.0;
+    double maxLatencyMs = 0.0;
+};
+
+// Headless mode: keeps re-slicing sheets in a folder as they change.
+// Work flows decode -> slice -> encode through bounded queues, one thread per
+// stage, so decoding the next sheet overlaps with encoding the previous one.
+int runWatchMode(const fs::path& watchDir) {
+#ifdef __linux__
+    const auto debounce = std::chrono::milliseconds(300);
+
+    std::error_code ec;
+    if (!fs::is_directory(watchDir, ec)) {
+        std::cerr << "Error: Not a directory: " << watchDir.string() << std::endl;
+        return 1;
+    }
+
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0 || inotify_add_watch(fd, watchDir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        std::cerr << "Error: Failed to watch " << watchDir.string() << ": " << strerror(errno) << std::endl;
+        if (fd >= 0) close(fd);
+        return 1;
+    }
+
+    std::signal(SIGINT, watchSignalHandler);
+    std::signal(SIGTERM, watchSignalHandler);
+
+    BlockingQueue<SheetJob> decodeQueue(64);
+    BlockingQueue<SheetJob> sliceQueue(2);
+    BlockingQueue<SheetJob> encodeQueue(2);
+    WatchStats stats;
+
+    // Paths waiting in decodeQueue; further events for them are coalesced.
+    std::mutex queuedMutex;
+    std::set<std::string> queuedPaths;
+
+    auto fail = [&](const SheetJob& job, const std::string& reason) {
+        std::lock_guard<std::mutex> lock(stats.mutex);
+        stats.failures++;
+        std::cerr << "[watch] " << job.imagePath.filename().string() << ": " << reason << std::endl;
+    };
+
+    std::thread decodeThread([&] {
+        SheetJob job;
+        while (decodeQueue.pop(job)) {
+            {
+                std::lock_guard<std::mutex> lock(queuedMutex);
+                queuedPaths.erase(job.imagePath.string());
+            }
+
+            auto start = SteadyClock::now();
+            job.spriteNames.clear();
+            job.config = SpritesheetConfig();
+            copyString(job.config.outputDir, "output/" + job.imagePath.stem().string());
+
+            fs::path configPath = job.imagePath.string() + ".slicer";
+            if (!loadSliceConfig(configPath, job.config, job.spriteNames)) {
+                fail(job, "missing or invalid " + configPath.filename().string());
+                continue;
+            }
+            fs::path outputDir = job.config.outputDir;
+            if (outputDir.is_relative()) {
+                copyString(job.config.outputDir, (watchDir / outputDir).string());
+            }
+
+            // Same formats as the GUI: 16-bit PNGs keep their precision and the
+            // channel layout is converted per sprite at encode time.
+            if (stbi_is_16_bit(job.imagePath.c_str())) {
+                job.pixels.reset((unsigned char*)stbi_load_16(job.imagePath.c_str(), &job.width, &job.height,
+                                                              &job.channels, 0));
+                job.bitDepth = 16;
+            } else {
+                job.pixels.reset(stbi_load(job.imagePath.c_str(), &job.width, &job.height, &job.channels, 0));
+                job.bitDepth = 8;
+            }
+            if (!job.pixels) {
+                fail(job, std::string("failed to decode: ") + stbi_failure_reason());
+                continue;
+            }
+            job.decodeMs = elapsedMs(start);
+
+            if (!sliceQueue.push(std::move(job))) break;
+        }
+        sliceQueue.close();
+    });
+
+    std::thread sliceThread([&] {
+        SheetJob job;
+        while (sliceQueue.pop(job)) {
+            auto start = SteadyClock::now();
+            const SpritesheetConfig& config = job.config;
+
+            int availableWidth = job.width - config.marginX;
+            int availableHeight = job.height - config.marginY;
+            int spritesPerRow = std::max(1, (availableWidth + config.spacingX) / (config.spriteWidth + config.spacingX));
+            int spritesPerColumn = std::max(1, (availableHeight + config.spacingY) / (config.spriteHeight + config.spacingY));
+
+            job.tiles.resize(spritesPerRow * spritesPerColumn);
+            job.tilePaths.resize(job.tiles.size());
+
+            for (int row = 0; row < spritesPerColumn; row++) {
+                for (int col = 0; col < spritesPerRow; col++) {
+                    int spriteIndex = row * spritesPerRow + col;
+                    int startX = config.marginX + col * (config.spriteWidth + config.spacingX);
+                    int startY = config.marginY + row * (config.spriteHeight + config.spacingY);
+
+                    extractSprite(job.pixels.get(), job.width, job.height, job.channels * job.bitDepth / 8,
+                                  startX, startY, config.spriteWidth, config.spriteHeight, job.tiles[spriteIndex]);
+                    job.tilePaths[spriteIndex] = std::string(config.outputDir) + "/" +
+                                                 spriteBaseName(config, job.spriteNames, spriteIndex) + ".png";
+                }
+            }
+
+            // The decoded sheet is no longer needed once it has been cut up.
+            job.pixels.reset();
+            job.sliceMs = elapsedMs(start);
+
+            if (!encodeQueue.push(std::move(job))) break;
+        }
+        encodeQueue.close();
+    });
+
+    std::thread encodeThread([&] {
+        SheetJob job;
+        while (encodeQueue.pop(job)) {
+            auto start = SteadyClock::now();
+            const SpritesheetConfig& config = job.config;
+
+            try {
+                fs::create_directories(config.outputDir);
+            } catch (const std::exception& e) {
+                fail(job, std::string("failed to create output directory: ") + e.what());
+                continue;
+            }
+
+            int outputChannels = config.outputChannels ? config.outputChannels : job.channels;
+            std::vector<unsigned char> converted;
+            std::vector<uint8_t> indexScratch;
+            int mismatches = 0;
+            int written = 0;
+            for (size_t i = 0; i < job.tiles.size(); i++) {
+                if (writeCroppedSprite(job.tilePaths[i], config.spriteWidth, config.spriteHeight, job.tiles[i],
+                                       job.channels, job.bitDepth, outputChannels, nullptr, false,
+                                       converted, indexScratch, mismatches, nullptr)) {
+                    written++;
+                }
+            }
+            job.tiles.clear();
+            job.encodeMs = elapsedMs(start);
+
+            double latencyMs = elapsedMs(job.changedAt);
+            std::lock_guard<std::mutex> lock(stats.mutex);
+            stats.sheets++;
+            stats.sprites += written;
+            stats.totalLatencyMs += latencyMs;
+            stats.maxLatencyMs = std::max(stats.maxLatencyMs, latencyMs);
+
+            printf("[watch] %s: %d sprites | decode %.1fms slice %.1fms encode %.1fms | latency %.1fms | "
+                   "queued decode=%zu slice=%zu encode=%zu\n",
+                   job.imagePath.filename().string().c_str(), written,
+                   job.decodeMs, job.sliceMs, job.encodeMs, latencyMs,
+                   decodeQueue.depth(), sliceQueue.depth(), encodeQueue.depth());
+            fflush(stdout);
+        }
+    });
+
+    // Slice whatever is already there before waiting for changes.
+    for (const auto& entry : fs::directory_iterator(watchDir, ec)) {
+        if (entry.is_regular_file() && isImageFile(entry.path()) &&
+            fs::exists(entry.path().string() + ".slicer")) {
+            {
+                std::lock_guard<std::mutex> lock(queuedMutex);
+                queuedPaths.insert(entry.path().string());
+            }
+            SheetJob job;
+            job.imagePath = entry.path();
+            job.changedAt = SteadyClock::now();
+            decodeQueue.push(std::move(job));
+        }
+    }
+
+    std::map<std::string, SteadyClock::time_point> pending;
+
+    printf("[watch] Watching %s (Ctrl+C to stop)\n", watchDir.string().c_str());
+    fflush(stdout);
+
+    alignas(struct inotify_event) char buffer[4096];
+    while (!watchStopRequested) {
+        struct pollfd pfd = {fd, POLLIN, 0};
+        poll(&pfd, 1, 50);
+
+        ssize_t len;
+        while ((len = read(fd, buffer, sizeof(buffer))) > 0) {
+            for (char* ptr = buffer; ptr < buffer + len; ptr += sizeof(struct inotify_event) + ((struct inotify_event*)ptr)->len) {
+                const struct inotify_event* event = (const struct inotify_event*)ptr;
+                if (event->len == 0 || (event->mask & IN_ISDIR)) continue;
+
+                fs::path changed = watchDir / event->name;
+                if (changed.extension() == ".slicer") {
+                    changed.replace_extension();
+                }
+                if (!isImageFile(changed)) continue;
+
+                // Restart the quiet period on every event so bursts of saves
+                // from an editor collapse into a single re-slice.
+                pending[changed.string()] = SteadyClock::now();
+            }
+        }
+
+        auto now = SteadyClock::now();
+        for (auto it = pending.begin(); it != pending.end();) {
+            if (now - it->second < debounce) {
+                ++it;
+                continue;
+            }
+
+            bool alreadyQueued;
+            {
+                std::lock_guard<std::mutex> lock(queuedMutex);
+                alreadyQueued = !queuedPaths.insert(it->first).second;
+            }
+            if (!alreadyQueued && fs::exists(it->first)) {
+                SheetJob job;
+                job.imagePath = it->first;
+                job.changedAt = it->second;
+                decodeQueue.push(std::move(job));
+            }
+            it = pending.erase(it);
+        }
+    }
+
+    decodeQueue.close();
+    decodeThread.join();
+    sliceThread.join();
+    encodeThread.join();
+    close(fd);
+
+    printf("[watch] %d sheets, %d sprites, %d failures | latency avg %.1fms max %.1fms | "
+           "peak queue decode=%zu slice=%zu encode=%zu\n",
+           stats.sheets, stats.sprites, stats.failures,
+           stats.sheets ? stats.totalLatencyMs / stats.sheets : 0.0, stats.maxLatencyMs,
+           decodeQueue.peakDepth(), sliceQueue.peakDepth(), encodeQueue.peakDepth());
+    return 0;
+#else
+    (void)watchDir;
+    std::cerr << "Error: Watch mode requires Linux (inotify)" << std::endl;
+    return 1;
+#endif
+}
+
+// Scrollable list of every cell with a thumbnail, selection toggle and name field.
+// Rows are virtualized with ImGuiListClipper and thumbnails are UV sub-rects of
+// the sheet texture, so the cost depends on visible rows rather than sprite count.
+void drawSpriteBrowser(const ImageTexture& texture, const SpritesheetConfig& config,
+                       std::vector<bool>& selectedSprites, std::map<int, std::string>& spriteNames) {
+    if (selectedSprites.empty() || config.spriteWidth <= 0 || config.spriteHeight <= 0) return;
+
+    int availableWidth = texture.width - config.marginX;
+    int spritesPerRow = std::max(1, (availableWidth + config.spacingX) / (config.spriteWidth + config.spacingX));
+
+    const float thumbSize = 48.0f;
+    float thumbScale = thumbSize / std::max(config.spriteWidth, config.spriteHeight);
+    ImVec2 thumbExtent(config.spriteWidth * thumbScale, config.spriteHeight * thumbScale);
+    // A row is the thumbnail beside a label line and the name field, whichever is taller.
+    float rowHeight = std::max(thumbSize, ImGui::GetTextLineHeightWithSpacing() + ImGui::GetFrameHeight()) +
+                      ImGui::GetStyle().ItemSpacing.y;
+
+    ImGui::Text("%d sprites (click a thumbnail to toggle selection)", (int)selectedSprites.size());
+    ImGui::BeginChild("SpriteList");
+
+    ImGuiListClipper clipper;
+    clipper.Begin((int)selectedSprites.size(), rowHeight);
+    while (clipper.Step()) {
+        for (int spriteIndex = clipper.DisplayStart; spriteIndex < clipper.DisplayEnd; spriteIndex++) {
+            int row = spriteIndex / spritesPerRow;
+            int col = spriteIndex % spritesPerRow;
+            float x = (float)(config.marginX + col * (config.spriteWidth + config.spacingX));
+            float y = (float)(config.marginY + row * (config.spriteHeight + config.spacingY));
+
+            ImGui::PushID(spriteIndex);
+
+            ImVec2 cellMin = ImGui::GetCursorScreenPos();
+            if (ImGui::InvisibleButton("##Thumb", ImVec2(thumbSize, thumbSize))) {
+                selectedSprites[spriteIndex] = !selectedSprites[spriteIndex];
+            }
+            bool hovered = ImGui::IsItemHovered();
+
+            ImDrawList* drawList = ImGui::GetWindowDrawList();
+            ImVec2 cellMax(cellMin.x + thumbSize, cellMin.y + thumbSize);
+            ImVec2 imageMin(cellMin.x + (thumbSize - thumbExtent.x) * 0.5f, cellMin.y + (thumbSize - thumbExtent.y) * 0.5f);
+            ImVec2 imageMax(imageMin.x + thumbExtent.x, imageMin.y + thumbExtent.y);
+            drawList->AddRectFilled(cellMin, cellMax, IM_COL32(30, 32, 34, 255));
+            drawList->AddImage((void*)(intptr_t)texture.textureID, imageMin, imageMax,
+                               ImVec2(x / texture.width, y / texture.height),
+                               ImVec2((x + config.spriteWidth) / texture.width, (y + config.spriteHeight) / texture.height));
+
+            if (hovered) {
+                drawList->AddRect(cellMin, cellMax, IM_COL32(66, 150, 250, 255), 0.0f, 0, 2.0f);
+            } else if (selectedSprites[spriteIndex]) {
+                drawList->AddRect(cellMin, cellMax, IM_COL32(50, 205, 50, 255), 0.0f, 0, 2.0f);
+            }
+
+            ImGui::SameLine();
+            ImGui::BeginGroup();
+            ImGui::Text("#%d  %s", spriteIndex, selectedSprites[spriteIndex] ? "(selected)" : "");
+
+            char nameBuffer[64] = "";
+            auto it = spriteNames.find(spriteIndex);
+            if (it != spriteNames.end()) {
+                copyString(nameBuffer, it->second);
+            }
+            std::string defaultName = std::string(config.spritePrefix) + "_" + std::to_string(spriteIndex);
+            ImGui::SetNextItemWidth(-1);
+            if (ImGui::InputTextWithHint("##Name", defaultName.c_str(), nameBuffer, sizeof(nameBuffer))) {
+                if (strlen(nameBuffer) > 0) {
+                    spriteNames[spriteIndex] = nameBuffer;
+                } else {
+                    spriteNames.erase(spriteIndex);
+                }
+            }
+            ImGui::EndGroup();
+
+            ImGui::PopID();
+        }
+    }
+    clipper.End();
+
+    ImGui::EndChild();
+}
+
+// Resets selection, names and view after a new sheet has been loaded.
+void resetSheetState(const ImageTexture& texture, SpritesheetConfig& config,
+                     std::vector<bool>& selectedSprites, std::map<int, std::string>& spriteNames,
+                     int& editingSprite) {
+    int availableWidth = texture.width - config.marginX;
+    int availableHeight = texture.height - config.marginY;
+    int spritesPerRow = std::max(1, (availableWidth + config.spacingX) / (config.spriteWidth + config.spacingX));
+    int spritesPerCol = std::max(1, (availableHeight + config.spacingY) / (config.spriteHeight + config.spacingY));
+    int totalSprites = spritesPerRow * spritesPerCol;
+
+    selectedSprites.assign(totalSprites, true);
+    spriteNames.clear();
+    editingSprite = -1;
+    config.zoomLevel = 1.0f;
+    config.panOffset = ImVec2(0, 0);
+}
+
 static void glfw_error_callback(int error, const char* description) {
     std::cerr << "GLFW Error " << error << ": " << description << std::endl;
 }
 
-int main(int, char**) {
+static const char* defaultHarnessScript = R"(# One command per line; coordinates are window pixels (1600x900 window).
+sprite 32 32
+load
+idle 30
+hover 520 80 1580 880 120
+zoom 1050 480 20
+hover 1580 80 520 880 120
+click 900 400
+click 920 400 1   # opens the rename popup
+escape            # ...and closes it again so later input reaches the preview
+idle 10
+pan 300 150 60
+hover 520 880 1580 80 120
+zoom 1050 480 -30
+sprite 8 8
+idle 30
+hover 520 80 1580 880 120
+)";
+
+// Replays a scripted session through the real frame loop on synthetic sheets
+// and records per-frame CPU time and draw-list size, so UI changes can be
+// compared against a previous run. Enabled with --frame-harness.
+class FrameHarness {
+public:
+    bool active = false;
+
+    bool parseArgs(int argc, char** argv) {
+        active = true;
+        std::string scriptText = defaultHarnessScript;
+        sizes = {1024, 2048, 4096, 8192, 16384};
+
+        for (int i = 2; i < argc; i++) {
+            std::string arg = argv[i];
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value) {
+                std::cerr << "Error: Missing value for " << arg << std::endl;
+                return false;
+            }
+            i++;
+
+            if (arg == "--script") {
+                std::ifstream file(value);
+                if (!file.is_open()) {
+                    std::cerr << "Error: Cannot read script " << value << std::endl;
+                    return false;
+                }
+                scriptText.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            } else if (arg == "--sizes") {
+                sizes.clear();
+                for (const char* p = value; *p; p++) {
+                    if (p == value || p[-1] == ',') sizes.push_back(std::atoi(p));
+                }
+            } else if (arg == "--csv") {
+                csvPath = value;
+            } else if (arg == "--summary") {
+                summaryPath = value;
+            } else if (arg == "--baseline") {
+                baselinePath = value;
+            } else {
+                std::cerr << "Error: Unknown harness option " << arg << std::endl;
+                return false;
+            }
+        }
+        return parseScript(scriptText);
+    }
+
+    // Called once the GL context exists; skips sizes the driver can't hold.
+    void start() {
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+        skipUnsupportedSizes();
+    }
+
+    bool finished() const { return sizeIndex >= sizes.size(); }
+
+    // Queues this frame's scripted input; must run before ImGui::NewFrame.
+    void beginFrame(ImGuiIO& io, ImageTexture& texture, SpritesheetConfig& config,
+                    std::vector<bool>& selectedSprites, std::map<int, std::string>& spriteNames,
+                    int& editingSprite, std::string& statusMessage) {
+        const FrameInput& input = script[frameIndex];
+        if (frameIndex == 0) results.push_back({sizes[sizeIndex], {}});
+
+        if (input.spriteWidth > 0) {
+            config.spriteWidth = input.spriteWidth;
+            config.spriteHeight = input.spriteHeight;
+            if (texture.textureID) resetSheetState(texture, config, selectedSprites, spriteNames, editingSprite);
+        }
+        if (input.load) {
+            loadSyntheticSheet(texture, sizes[sizeIndex]);
+            resetSheetState(texture, config, selectedSprites, spriteNames, editingSprite);
+            statusMessage = "Synthetic sheet " + std::to_string(texture.width) + "x" + std::to_string(texture.height);
+        }
+        config.panOffset.x += input.pan.x;
+        config.panOffset.y += input.pan.y;
+
+        io.AddMousePosEvent(input.mousePos.x, input.mousePos.y);
+        if (input.wheel != 0.0f) io.AddMouseWheelEvent(0.0f, input.wheel);
+        if (input.press >= 0) io.AddMouseButtonEvent(input.press, true);
+        if (input.release >= 0) io.AddMouseButtonEvent(input.release, false);
+        if (input.escape) io.AddKeyEvent(ImGuiKey_Escape, input.escapeDown);
+
+        // Sheet uploads are setup cost, not frame cost.
+        measureFrame = !input.load;
+        frameStart = SteadyClock::now();
+    }
+
+    void endFrame(const ImDrawData* drawData) {
+        if (measureFrame) {
+            results.back().frames.push_back({elapsedMs(frameStart), drawData->TotalVtxCount, drawData->TotalIdxCount});
+        }
+        if (++frameIndex == script.size()) {
+            frameIndex = 0;
+            sizeIndex++;
+            skipUnsupportedSizes();
+        }
+    }
+
+    int report() const {
+        std::map<int, std::vector<double>> baseline;
+        if (!baselinePath.empty()) baseline = readSummary(baselinePath);
+
+        std::ofstream summary;
+        if (!summaryPath.empty()) {
+            summary.open(summaryPath);
+            summary << "size,frames,p50_ms,p90_ms,p99_ms,max_ms,avg_vertices,max_vertices\n";
+        }
+        std::ofstream perFrame;
+        if (!csvPath.empty()) {
+            perFrame.open(csvPath);
+            perFrame << "size,frame,cpu_ms,vertices,indices\n";
+        }
+
+        printf("%-12s %7s %8s %8s %8s %8s %12s %12s\n",
+               "sheet", "frames", "p50 ms", "p90 ms", "p99 ms", "max ms", "avg verts", "max verts");
+        for (const SizeResult& result : results) {
+            if (result.frames.empty()) continue;
+
+            std::vector<double> times;
+            double vertexSum = 0;
+            int maxVertices = 0;
+            for (size_t i = 0; i < result.frames.size(); i++) {
+                const FrameSample& frame = result.frames[i];
+                times.push_back(frame.cpuMs);
+                vertexSum += frame.vertices;
+                maxVertices = std::max(maxVertices, frame.vertices);
+                if (perFrame.is_open()) {
+                    perFrame << result.size << "," << i << "," << frame.cpuMs << ","
+                             << frame.vertices << "," << frame.indices << "\n";
+                }
+            }
+            std::sort(times.begin(), times.end());
+            auto percentile = [&](double p) { return times[std::min(times.size() - 1, (size_t)(p * times.size()))]; };
+
+            std::vector<double> row = {percentile(0.50), percentile(0.90), percentile(0.99), times.back(),
+                                       vertexSum / times.size(), (double)maxVertices};
+            std::string label = std::to_string(result.size) + "x" + std::to_string(result.size);
+            printf("%-12s %7zu %8.3f %8.3f %8.3f %8.3f %12.0f %12d\n",
+                   label.c_str(), times.size(), row[0], row[1], row[2], row[3], row[4], maxVertices);
+
+            auto base = baseline.find(result.size);
+            if (base != baseline.end() && base->second.size() >= 6) {
+                auto delta = [](double now, double before) { return before > 0 ? (now / before - 1.0) * 100.0 : 0.0; };
+                printf("%-12s vs baseline: p50 %+.1f%%  p99 %+.1f%%  avg verts %+.1f%%\n", "",
+                       delta(row[0], base->second[0]), delta(row[2], base->second[2]), delta(row[4], base->second[4]));
+            }
+
+            if (summary.is_open()) {
+                summary << result.size << "," << times.size();
+                for (double value : row) summary << "," << value;
+                summary << "\n";
+            }
+        }
+        return 0;
+    }
+
+private:
+    struct FrameInput {
+        ImVec2 mousePos;
+        ImVec2 pan;
+        float wheel = 0.0f;
+        int press = -1;
+        int release = -1;
+        bool escape = false;
+        bool escapeDown = false;
+        bool load = false;
+        int spriteWidth = 0;
+        int spriteHeight = 0;
+    };
+
+    struct FrameSample {
+        double cpuMs;
+        int vertices;
+        int indices;
+    };
+
+    struct SizeResult {
+        int size;
+        std::vector<FrameSample> frames;
+    };
+
+    bool parseScript(const std::string& text) {
+        std::istringstream lines(text);
+        std::string line;
+        ImVec2 mouse(-FLT_MAX, -FLT_MAX);
+        int lineNumber = 0;
+
+        while (std::getline(lines, line)) {
+            lineNumber++;
+            line = line.substr(0, line.find('#'));
+            std::istringstream words(line);
+            std::string command;
+            if (!(words >> command)) continue;
+
+            FrameInput frame;
+            frame.mousePos = mouse;
+            bool ok = true;
+
+            if (command == "load") {
+                frame.load = true;
+                script.push_back(frame);
+            } else if (command == "sprite") {
+                ok = static_cast<bool>(words >> frame.spriteWidth >> frame.spriteHeight);
+                script.push_back(frame);
+            } else if (command == "idle") {
+                int frames = 0;
+                ok = static_cast<bool>(words >> frames);
+                script.insert(script.end(), std::max(0, frames), frame);
+            } else if (command == "move") {
+                ok = static_cast<bool>(words >> mouse.x >> mouse.y);
+                frame.mousePos = mouse;
+                script.push_back(frame);
+            } else if (command == "hover") {
+                ImVec2 from, to;
+                int frames = 0;
+                ok = static_cast<bool>(words >> from.x >> from.y >> to.x >> to.y >> frames) && frames > 0;
+                for (int i = 0; ok && i < frames; i++) {
+                    float t = (frames > 1) ? (float)i / (frames - 1) : 1.0f;
+                    frame.mousePos = ImVec2(from.x + (to.x - from.x) * t, from.y + (to.y - from.y) * t);
+                    script.push_back(frame);
+                }
+                mouse = to;
+            } else if (command == "zoom") {
+                int steps = 0;
+                ok = static_cast<bool>(words >> mouse.x >> mouse.y >> steps);
+                frame.mousePos = mouse;
+                frame.wheel = (steps < 0) ? -1.0f : 1.0f;
+                script.insert(script.end(), std::abs(steps), frame);
+            } else if (command == "click") {
+                int button = 0;
+                ok = static_cast<bool>(words >> mouse.x >> mouse.y);
+                words >> button;
+                frame.mousePos = mouse;
+                frame.press = button;
+                script.push_back(frame);
+                frame.press = -1;
+                frame.release = button;
+                script.push_back(frame);
+            } else if (command == "escape") {
+                frame.escape = true;
+                frame.escapeDown = true;
+                script.push_back(frame);
+                frame.escapeDown = false;
+                script.push_back(frame);
+            } else if (command == "pan") {
+                ImVec2 delta;
+                int frames = 0;
+                ok = static_cast<bool>(words >> delta.x >> delta.y >> frames) && frames > 0;
+                // The UI has no drag-to-pan yet, so the offset is driven directly.
+                frame.pan = ImVec2(delta.x / std::max(1, frames), delta.y / std::max(1, frames));
+                script.insert(script.end(), std::max(0, frames), frame);
+            } else {
+                ok = false;
+            }
+
+            if (!ok) {
+                std::cerr << "Error: Bad harness script line " << lineNumber << ": " << line << std::endl;
+                return false;
+            }
+        }
+
+        if (script.empty()) {
+            std::cerr << "Error: Harness script is empty" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    void skipUnsupportedSizes() {
+        while (sizeIndex < sizes.size() && (sizes[sizeIndex] <= 0 || sizes[sizeIndex] > maxTextureSize)) {
+            std::cerr << "Skipping " << sizes[sizeIndex] << "x" << sizes[sizeIndex]
+                      << " sheet (GL_MAX_TEXTURE_SIZE is " << maxTextureSize << ")" << std::endl;
+            sizeIndex++;
+        }
+    }
+
+    // Opaque 32x32 cells of varying colour separated by transparent gutters,
+    // so grid, selection and thumbnails all have something to draw.
+    static void loadSyntheticSheet(ImageTexture& texture, int size) {
+        texture.release();
+        texture.width = size;
+        texture.height = size;
+        texture.channels = 4;
+        texture.bitDepth = 8;
+        texture.data = (unsigned char*)malloc((size_t)size * size * 4);
+        if (!texture.data) return;
+
+        uint32_t* pixels = (uint32_t*)texture.data;
+        for (int y = 0; y < size; y++) {
+            for (int x = 0; x < size; x++) {
+                uint32_t cell = (uint32_t)(x / 32) * 73856093u ^ (uint32_t)(y / 32) * 19349663u;
+                bool gutter = (x % 32) < 2 || (y % 32) < 2;
+                pixels[(size_t)y * size + x] = gutter ? 0 : 0xFF000000u | (cell & 0xFFFFFFu);
+            }
+        }
+        texture.upload();
+    }
+
+    static std::map<int, std::vector<double>> readSummary(const std::string& path) {
+        std::map<int, std::vector<double>> rows;
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        while (std::getline(file, line)) {
+            std::istringstream fields(line);
+            std::string field;
+            std::vector<double> values;
+            while (std::getline(fields, field, ',')) values.push_back(std::atof(field.c_str()));
+            if (values.size() >= 8) rows[(int)values[0]] = std::vector<double>(values.begin() + 2, values.end());
+        }
+        return rows;
+    }
+
+    std::vector<FrameInput> script;
+    std::vector<int> sizes;
+    std::vector<SizeResult> results;
+    size_t sizeIndex = 0;
+    size_t frameIndex = 0;
+    GLint maxTextureSize = 0;
+    bool measureFrame = false;
+    SteadyClock::time_point frameStart;
+    std::string csvPath;
+    std::string summaryPath;
+    std::string baselinePath;
+};
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "--watch") == 0) {
+        if (argc < 3) {
+            std::cerr << "Usage: " << argv[0] << " --watch <directory>" << std::endl;
+            return 1;
+        }
+        return runWatchMode(argv[2]);
+    }
+
+    FrameHarness harness;
+    if (argc >= 2 && strcmp(argv[1], "--frame-harness") == 0 && !harness.parseArgs(argc, argv)) {
+        return 1;
+    }
+
     glfwSetErrorCallback(glfw_error_callback);
     if (!glfwInit()) return 1;
 
     const char* glsl_version = "#version 130";
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+    if (harness.active) glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
 
     GLFWwindow* window = glfwCreateWindow(1600, 900, "Sprite Sheet Slicer", nullptr, nullptr);
     if (window == nullptr) return 1;
 
     glfwMakeContextCurrent(window);
-    glfwSwapInterval(1);
+    // The harness measures CPU time per frame, so it must not wait for vsync.
+    glfwSwapInterval(harness.active ? 0 : 1);
 
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
@@ -331,6 +1955,11 @@ int main(int, char**) {
     ImGui_ImplGlfw_InitForOpenGL(window, true);
     ImGui_ImplOpenGL3_Init(glsl_version);
 
+    if (harness.active) {
+        io.IniFilename = nullptr;
+        harness.start();
+    }
+
     SpritesheetConfig config;
     ImageTexture spritesheetTexture;
     std::string statusMessage = "Load a spritesheet to begin";
@@ -343,11 +1972,15 @@ int main(int, char**) {
 
     ImVec4 clear_color = ImVec4(0.10f, 0.10f, 0.10f, 1.00f);
 
-    while (!glfwWindowShouldClose(window)) {
+    while (!glfwWindowShouldClose(window) && !(harness.active && harness.finished())) {
         glfwPollEvents();
 
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
+        if (harness.active) {
+            harness.beginFrame(io, spritesheetTexture, config, selectedSprites, spriteNames,
+                               editingSprite, statusMessage);
+        }
         ImGui::NewFrame();
 
         ImGui::SetNextWindowPos(ImVec2(0, 0));
@@ -384,20 +2017,12 @@ int main(int, char**) {
 
         if (ImGui::Button("Load Image", ImVec2(-1, 40))) {
             if (spritesheetTexture.loadFromFile(config.inputPath)) {
+                static const char* layoutNames[] = {"Grey", "Grey + Alpha", "RGB", "RGBA"};
                 statusMessage = "Image loaded: " + std::to_string(spritesheetTexture.width) + "x" +
-                               std::to_string(spritesheetTexture.height) + " pixels";
-
-                int availableWidth = spritesheetTexture.width - config.marginX;
-                int availableHeight = spritesheetTexture.height - config.marginY;
-                int spritesPerRow = std::max(1, (availableWidth + config.spacingX) / (config.spriteWidth + config.spacingX));
-                int spritesPerCol = std::max(1, (availableHeight + config.spacingY) / (config.spriteHeight + config.spacingY));
-                int totalSprites = spritesPerRow * spritesPerCol;
-
-                selectedSprites.assign(totalSprites, true);
-                spriteNames.clear();
-                editingSprite = -1;
-                config.zoomLevel = 1.0f;
-                config.panOffset = ImVec2(0, 0);
+                               std::to_string(spritesheetTexture.height) + " pixels, " +
+                               layoutNames[spritesheetTexture.channels - 1] + " " +
+                               std::to_string(spritesheetTexture.bitDepth) + "-bit";
+                resetSheetState(spritesheetTexture, config, selectedSprites, spriteNames, editingSprite);
             } else {
                 statusMessage = "Error: Failed to load image";
             }
@@ -477,6 +2102,25 @@ int main(int, char**) {
         ImGui::InputText("Sprite Prefix", config.spritePrefix, sizeof(config.spritePrefix));
         Tooltip("Default naming prefix (e.g., 'sprite' -> sprite_0.png)");
 
+        const char* pngFormats[] = {"Truecolor", "Indexed (lossless)", "Indexed (quantized)"};
+        ImGui::SetNextItemWidth(-1);
+        ImGui::Combo("##PngFormat", &config.pngFormat, pngFormats, 3);
+        Tooltip("Truecolor keeps the source channels. Indexed writes 1-8 bit palette PNGs sharing one palette "
+                "per sheet: lossless refuses sheets with more than 256 colors, quantized reduces them.");
+
+        const char* channelOptions[] = {"Same as source", "Grey", "Grey + Alpha", "RGB", "RGBA"};
+        ImGui::SetNextItemWidth(-1);
+        ImGui::Combo("##OutputChannels", &config.outputChannels, channelOptions, 5);
+        Tooltip("Channel layout of exported sprites, e.g. RGBA to add alpha to an RGB sheet");
+
+        ImGui::Text("Extra Scales");
+        ImGui::SameLine();
+        ImGui::Checkbox("0.5x", &config.exportHalfScale);
+        Tooltip("Also export each sprite at half size (name@0.5x.png)");
+        ImGui::SameLine();
+        ImGui::Checkbox("0.25x", &config.exportQuarterScale);
+        Tooltip("Also export each sprite at quarter size (name@0.25x.png)");
+
         ImGui::Spacing();
         ImGui::Checkbox("Show Grid", &config.showGrid);
         Tooltip("Toggle grid overlay visualization");
@@ -516,6 +2160,7 @@ int main(int, char**) {
                 int spritesPerRow = std::max(1, (availableWidth + config.spacingX) / (config.spriteWidth + config.spacingX));
                 int spritesPerCol = std::max(1, (availableHeight + config.spacingY) / (config.spriteHeight + config.spacingY));
 
+                std::vector<float> scales = exportScales(config);
                 std::string jsonPath = std::string(config.outputDir) + "/spritesheet.json";
                 try {
                     fs::create_directories(config.outputDir);
@@ -538,21 +2183,28 @@ int main(int, char**) {
                                 if (!first) jsonFile << ",\n";
                                 first = false;
 
-                                std::string name;
-                                auto it = spriteNames.find(idx);
-                                if (it != spriteNames.end() && !it->second.empty()) {
-                                    name = it->second;
-                                } else {
-                                    name = std::string(config.spritePrefix) + "_" + std::to_string(idx);
-                                }
+                                std::string name = spriteBaseName(config, spriteNames, idx);
 
                                 jsonFile << "    {\n";
                                 jsonFile << "      \"name\": \"" << name << "\",\n";
                                 jsonFile << "      \"x\": " << x << ",\n";
                                 jsonFile << "      \"y\": " << y << ",\n";
                                 jsonFile << "      \"w\": " << config.spriteWidth << ",\n";
-                                jsonFile << "      \"h\": " << config.spriteHeight << "\n";
-                                jsonFile << "    }";
+                                jsonFile << "      \"h\": " << config.spriteHeight;
+                                if (scales.size() > 1) {
+                                    jsonFile << ",\n      \"scales\": [\n";
+                                    for (size_t i = 0; i < scales.size(); i++) {
+                                        int scaledWidth = scaledSpriteSize(config.spriteWidth, scales[i]);
+                                        int scaledHeight = scaledSpriteSize(config.spriteHeight, scales[i]);
+                                        jsonFile << "        { \"scale\": " << scales[i]
+                                                 << ", \"file\": \"" << name << scaleSuffix(scales[i]) << ".png\""
+                                                 << ", \"w\": " << scaledWidth
+                                                 << ", \"h\": " << scaledHeight << " }"
+                                                 << (i + 1 < scales.size() ? ",\n" : "\n");
+                                    }
+                                    jsonFile << "      ]";
+                                }
+                                jsonFile << "\n    }";
                             }
                         }
                         jsonFile << "\n  ]\n}\n";
@@ -587,113 +2239,126 @@ int main(int, char**) {
         ImGui::BeginChild("Preview", ImVec2(0, 0), true);
 
         if (spritesheetTexture.textureID) {
-            ImVec2 preview_size = ImGui::GetContentRegionAvail();
-
-            ImGui::Text("Zoom: %.0f%% (Use mouse wheel to zoom)", config.zoomLevel * 100.0f);
-            ImGui::SameLine(preview_size.x - 150);
-            if (ImGui::Button("Reset View", ImVec2(140, 0))) {
-                config.zoomLevel = 1.0f;
-                config.panOffset = ImVec2(0, 0);
-            }
-            Tooltip("Reset zoom and pan");
+            if (ImGui::BeginTabBar("PreviewTabs")) {
+                if (ImGui::BeginTabItem("Sheet")) {
+                    ImVec2 preview_size = ImGui::GetContentRegionAvail();
+
+                    ImGui::Text("Zoom: %.0f%% (Use mouse wheel to zoom)", config.zoomLevel * 100.0f);
+                    ImGui::SameLine(preview_size.x - 150);
+                    if (ImGui::Button("Reset View", ImVec2(140, 0))) {
+                        config.zoomLevel = 1.0f;
+                        config.panOffset = ImVec2(0, 0);
+                    }
+                    Tooltip("Reset zoom and pan");
 
-            preview_size = ImGui::GetContentRegionAvail();
-            float aspect = (float)spritesheetTexture.width / (float)spritesheetTexture.height;
+                    preview_size = ImGui::GetContentRegionAvail();
+                    float aspect = (float)spritesheetTexture.width / (float)spritesheetTexture.height;
 
-            ImVec2 base_image_size;
-            if (preview_size.x / aspect < preview_size.y) {
-                base_image_size.x = preview_size.x - 20;
-                base_image_size.y = base_image_size.x / aspect;
-            } else {
-                base_image_size.y = preview_size.y - 20;
-                base_image_size.x = base_image_size.y * aspect;
-            }
+                    ImVec2 base_image_size;
+                    if (preview_size.x / aspect < preview_size.y) {
+                        base_image_size.x = preview_size.x - 20;
+                        base_image_size.y = base_image_size.x / aspect;
+                    } else {
+                        base_image_size.y = preview_size.y - 20;
+                        base_image_size.x = base_image_size.y * aspect;
+                    }
 
-            ImVec2 image_size(base_image_size.x * config.zoomLevel, base_image_size.y * config.zoomLevel);
+                    ImVec2 image_size(base_image_size.x * config.zoomLevel, base_image_size.y * config.zoomLevel);
 
-            ImVec2 image_pos = ImGui::GetCursorScreenPos();
-            image_pos.x += (preview_size.x - image_size.x) * 0.5f + config.panOffset.x;
-            image_pos.y += 10 + config.panOffset.y;
+                    ImVec2 image_pos = ImGui::GetCursorScreenPos();
+                    image_pos.x += (preview_size.x - image_size.x) * 0.5f + config.panOffset.x;
+                    image_pos.y += 10 + config.panOffset.y;
 
-            ImGui::SetCursorScreenPos(image_pos);
-            ImGui::Image((void*)(intptr_t)spritesheetTexture.textureID, image_size);
+                    ImGui::SetCursorScreenPos(image_pos);
+                    ImGui::Image((void*)(intptr_t)spritesheetTexture.textureID, image_size);
 
-            if (ImGui::IsItemHovered()) {
-                float wheel = io.MouseWheel;
-                if (wheel != 0) {
-                    float zoom_delta = wheel * 0.1f;
-                    config.zoomLevel = std::max(0.1f, std::min(5.0f, config.zoomLevel + zoom_delta));
-                }
+                    if (ImGui::IsItemHovered()) {
+                        float wheel = io.MouseWheel;
+                        if (wheel != 0) {
+                            float zoom_delta = wheel * 0.1f;
+                            config.zoomLevel = std::max(0.1f, std::min(5.0f, config.zoomLevel + zoom_delta));
+                        }
 
-                if (!selectedSprites.empty()) {
-                    ImVec2 mouse_pos = ImGui::GetMousePos();
-                    float relX = (mouse_pos.x - image_pos.x) / image_size.x * spritesheetTexture.width;
-                    float relY = (mouse_pos.y - image_pos.y) / image_size.y * spritesheetTexture.height;
+                        if (!selectedSprites.empty()) {
+                            ImVec2 mouse_pos = ImGui::GetMousePos();
+                            float relX = (mouse_pos.x - image_pos.x) / image_size.x * spritesheetTexture.width;
+                            float relY = (mouse_pos.y - image_pos.y) / image_size.y * spritesheetTexture.height;
 
-                    relX -= config.marginX;
-                    relY -= config.marginY;
+                            relX -= config.marginX;
+                            relY -= config.marginY;
 
-                    int col = relX / (config.spriteWidth + config.spacingX);
-                    int row = relY / (config.spriteHeight + config.spacingY);
+                            int col = relX / (config.spriteWidth + config.spacingX);
+                            int row = relY / (config.spriteHeight + config.spacingY);
 
-                    int availableWidth = spritesheetTexture.width - config.marginX;
-                    int availableHeight = spritesheetTexture.height - config.marginY;
-                    int spritesPerRow = std::max(1, (availableWidth + config.spacingX) / (config.spriteWidth + config.spacingX));
+                            int availableWidth = spritesheetTexture.width - config.marginX;
+                            int availableHeight = spritesheetTexture.height - config.marginY;
+                            int spritesPerRow = std::max(1, (availableWidth + config.spacingX) / (config.spriteWidth + config.spacingX));
 
-                    if (col >= 0 && row >= 0 && col < spritesPerRow) {
-                        hoveredSprite = row * spritesPerRow + col;
-                        if (hoveredSprite >= (int)selectedSprites.size()) hoveredSprite = -1;
+                            if (col >= 0 && row >= 0 && col < spritesPerRow) {
+                                hoveredSprite = row * spritesPerRow + col;
+                                if (hoveredSprite >= (int)selectedSprites.size()) hoveredSprite = -1;
 
-                        if (hoveredSprite >= 0 && ImGui::IsMouseClicked(0)) {
-                            selectedSprites[hoveredSprite] = !selectedSprites[hoveredSprite];
-                        }
+                                if (hoveredSprite >= 0 && ImGui::IsMouseClicked(0)) {
+                                    selectedSprites[hoveredSprite] = !selectedSprites[hoveredSprite];
+                                }
 
-                        if (hoveredSprite >= 0 && ImGui::IsMouseClicked(1)) {
-                            editingSprite = hoveredSprite;
-                            auto it = spriteNames.find(hoveredSprite);
-                            if (it != spriteNames.end()) {
-                                strncpy(editNameBuffer, it->second.c_str(), sizeof(editNameBuffer) - 1);
+                                if (hoveredSprite >= 0 && ImGui::IsMouseClicked(1)) {
+                                    editingSprite = hoveredSprite;
+                                    auto it = spriteNames.find(hoveredSprite);
+                                    if (it != spriteNames.end()) {
+                                        strncpy(editNameBuffer, it->second.c_str(), sizeof(editNameBuffer) - 1);
+                                    } else {
+                                        editNameBuffer[0] = '\0';
+                                    }
+                                    ImGui::OpenPopup("EditSpriteName");
+                                }
                             } else {
-                                editNameBuffer[0] = '\0';
+                                hoveredSprite = -1;
                             }
-                            ImGui::OpenPopup("EditSpriteName");
                         }
                     } else {
                         hoveredSprite = -1;
                     }
-                }
-            } else {
-                hoveredSprite = -1;
-            }
 
-            if (config.showGrid) {
-                ImDrawList* drawList = ImGui::GetWindowDrawList();
-                drawGrid(drawList, image_pos, image_size, spritesheetTexture, config, selectedSprites, hoveredSprite);
-            }
+                    if (config.showGrid) {
+                        ImDrawList* drawList = ImGui::GetWindowDrawList();
+                        drawGrid(drawList, image_pos, image_size, spritesheetTexture, config, selectedSprites, hoveredSprite);
+                    }
 
-            if (ImGui::BeginPopup("EditSpriteName")) {
-                ImGui::Text("Edit Sprite Name (Index: %d)", editingSprite);
-                ImGui::Separator();
-                ImGui::SetNextItemWidth(300);
-                ImGui::InputText("##EditName", editNameBuffer, sizeof(editNameBuffer));
-                if (ImGui::Button("Save", ImVec2(140, 0))) {
-                    if (strlen(editNameBuffer) > 0) {
-                        spriteNames[editingSprite] = editNameBuffer;
-                    } else {
-                        spriteNames.erase(editingSprite);
+                    if (ImGui::BeginPopup("EditSpriteName")) {
+                        // A new sheet was loaded while renaming; the index no longer applies.
+                        if (editingSprite < 0) ImGui::CloseCurrentPopup();
+                        ImGui::Text("Edit Sprite Name (Index: %d)", editingSprite);
+                        ImGui::Separator();
+                        ImGui::SetNextItemWidth(300);
+                        ImGui::InputText("##EditName", editNameBuffer, sizeof(editNameBuffer));
+                        if (ImGui::Button("Save", ImVec2(140, 0))) {
+                            if (strlen(editNameBuffer) > 0) {
+                                spriteNames[editingSprite] = editNameBuffer;
+                            } else {
+                                spriteNames.erase(editingSprite);
+                            }
+                            ImGui::CloseCurrentPopup();
+                        }
+                        ImGui::SameLine();
+                        if (ImGui::Button("Cancel", ImVec2(140, 0))) {
+                            ImGui::CloseCurrentPopup();
+                        }
+                        ImGui::EndPopup();
                     }
-                    ImGui::CloseCurrentPopup();
+                    ImGui::EndTabItem();
                 }
-                ImGui::SameLine();
-                if (ImGui::Button("Cancel", ImVec2(140, 0))) {
-                    ImGui::CloseCurrentPopup();
+
+                if (ImGui::BeginTabItem("Sprites")) {
+                    drawSpriteBrowser(spritesheetTexture, config, selectedSprites, spriteNames);
+                    ImGui::EndTabItem();
                 }
-                ImGui::EndPopup();
+                ImGui::EndTabBar();
             }
 
         } else {
             ImGui::SetCursorPosY(ImGui::GetCursorPosY() + 200);
-            ImGui::TextWrapped("Load a spritesheet image to begin.\n\nFeatures:\n- Click sprites to select/deselect\n- Right-click to rename sprites\n- Mouse wheel to zoom in/out\n- Visual grid overlay\n- Custom naming support");
+            ImGui::TextWrapped("Load a spritesheet image to begin.\n\nFeatures:\n- Click sprites to select/deselect\n- Right-click to rename sprites\n- Browse and rename every sprite in the Sprites tab\n- Mouse wheel to zoom in/out\n- Visual grid overlay\n- Custom naming support");
         }
 
         ImGui::EndChild();
@@ -707,10 +2372,13 @@ int main(int, char**) {
         glClearColor(clear_color.x, clear_color.y, clear_color.z, clear_color.w);
         glClear(GL_COLOR_BUFFER_BIT);
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        if (harness.active) harness.endFrame(ImGui::GetDrawData());
 
         glfwSwapBuffers(window);
     }
 
+    int exitCode = harness.active ? harness.report() : 0;
+
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
@@ -718,5 +2386,5 @@ int main(int, char**) {
     glfwDestroyWindow(window);
     glfwTerminate();
 
-    return 0;
+    return exitCode;
 }